@@ -0,0 +1,78 @@
+#ifndef BATCHSHOWER_HPP
+#define BATCHSHOWER_HPP
+
+#include <string>
+#include <vector>
+
+#include "Shower.hpp"
+
+/// Evolves a batch of events in lockstep: every step generates one trial
+/// emission for each event still above the cutoff, then applies the veto
+/// and the kinematics to all of them. Events that reach the cutoff are
+/// compacted out of the active list. The veto algorithm steps, kinematics
+/// and colour flow are the ones of Shower, so the distributions are the
+/// same; with batchSize 1 even the random sequence is the same.
+///
+/// With UseSudakovCache the first emission of each event comes from the
+/// Sudakov table, as in Shower, before the lockstep evolution starts.
+///
+/// The radiating channels (splitter, spectator, kernel) of each event
+/// are cached with their m2, zp and overestimate and only rebuilt after
+/// an emission, the trial scales are then a flat loop over the channels,
+/// and the veto runs grouped by kernel type without virtual calls.
+class BatchShower
+{
+private:
+  enum KernelType {PQQ = 0, PGG = 1, PGQ = 2};
+  /// radiating channels of one event
+  struct Channels
+  {
+    std::vector<size_t> split, spect, kern;
+    std::vector<double> m2, zp, invOverestimate;
+    inline size_t size() const {return kern.size();}
+    void clear();
+  };
+
+  Shower _shower;
+  double _tEnd;
+  class Random* _ran;
+  size_t _batchSize;
+  std::vector<KernelType> _kernType;
+  /// per-event state, indexed by batch slot
+  std::vector<class EventInfo*> _evts;
+  std::vector<double> _tActual;
+  std::vector<int> _c;
+  std::vector<Channels> _channels;
+  /// per-trial state, indexed by position in the active list
+  std::vector<size_t> _active, _chan;
+  std::vector<double> _t, _z, _y;
+  std::vector<char> _accept;
+  std::vector<size_t> _byType[3];
+  std::vector<double> _tt;
+
+  void RunBatch(class EventInfo* evts, const size_t n);
+  void FindChannels(const size_t slot);
+  size_t SelectSplitSpect(const size_t nactive);
+  void Veto(const size_t nactive);
+  template <class K>
+  void Veto(const std::vector<size_t>& trials);
+  void MakeEmissions(const size_t nactive);
+public:
+  /// same arguments as Shower, plus the number of events per batch
+  BatchShower(class AlphaS* alphaS, class Random* ran,
+              const double t0, const size_t batchSize=64);
+  ~BatchShower() {}
+
+  /// see Shower::UseSudakovCache
+  inline bool UseSudakovCache(const std::string& file = "")
+  {
+    return _shower.UseSudakovCache(file);
+  }
+
+  /// Shower all events, batchSize at a time. Each event starts from
+  /// the invariant mass squared of its two incoming leptons.
+  void Run(std::vector<class EventInfo>& evts);
+  inline size_t GetBatchSize() const {return _batchSize;}
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef CONFIG_HPP
+#define CONFIG_HPP
+
+/// TOYSHOWER_HOT marks the hot paths of the shower evolution.
+/// With TOYSHOWER_FMV the compiler emits one clone per x86-64
+/// micro-architecture level and the loader picks the best one at
+/// start-up, otherwise it expands to nothing.
+/// Virtual functions (the splitting kernels) cannot be cloned, and only
+/// functions called from their own translation unit are marked: GCC
+/// cannot resolve clones called from another one (ODR/link errors with LTO).
+/// Helpers shared between translation units are inline in the headers
+/// instead; TOYSHOWER_INLINE forces them into every clone so that each
+/// gets a copy compiled for its micro-architecture.
+/// GCC spelling only, the build refuses TOYSHOWER_FMV with other compilers.
+#if defined(TOYSHOWER_FMV) && defined(__GNUC__) && !defined(__clang__) \
+  && defined(__x86_64__)
+#define TOYSHOWER_HOT \
+  __attribute__((target_clones("default", "arch=x86-64-v3", "arch=x86-64-v4")))
+#define TOYSHOWER_INLINE inline __attribute__((always_inline))
+#else
+#define TOYSHOWER_HOT
+#define TOYSHOWER_INLINE inline
+#endif
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef FOURVECTOR_HPP
+#define FOURVECTOR_HPP
+
+#include <cmath>
+#include <ostream>
+#include <vector>
+
+/// Minimal replacements for the Rivet vector types, so that the
+/// shower core does not depend on Rivet/HepMC.
+class ThreeVector
+{
+private:
+  double _v[3];
+public:
+  explicit ThreeVector()
+  : _v{0., 0., 0.}
+  {}
+  explicit ThreeVector(const double x, const double y, const double z)
+  : _v{x, y, z}
+  {}
+  inline double  operator[](const size_t i) const {return _v[i];}
+  inline double& operator[](const size_t i)       {return _v[i];}
+  inline double mod2() const {return _v[0]*_v[0] + _v[1]*_v[1] + _v[2]*_v[2];}
+  inline double mod()  const {return sqrt(mod2());}
+
+  inline ThreeVector& operator*=(const double a)
+  {
+    _v[0] *= a; _v[1] *= a; _v[2] *= a;
+    return *this;
+  }
+
+  inline friend std::ostream& operator<<(std::ostream& os, const ThreeVector& v)
+  {
+    os << "(" << v[0] << ", " << v[1] << ", " << v[2] << ")";
+    return os;
+  }
+};
+
+inline ThreeVector cross(const ThreeVector& a, const ThreeVector& b)
+{
+  return ThreeVector{a[1]*b[2] - a[2]*b[1],
+                     a[2]*b[0] - a[0]*b[2],
+                     a[0]*b[1] - a[1]*b[0]};
+}
+
+class FourMomentum
+{
+private:
+  double _E, _px, _py, _pz;
+public:
+  explicit FourMomentum()
+  : _E{0.}, _px{0.}, _py{0.}, _pz{0.}
+  {}
+  explicit FourMomentum(const double E, const double px,
+                        const double py, const double pz)
+  : _E{E}, _px{px}, _py{py}, _pz{pz}
+  {}
+  inline double E()  const {return _E;}
+  inline double px() const {return _px;}
+  inline double py() const {return _py;}
+  inline double pz() const {return _pz;}
+  inline ThreeVector vector3() const {return ThreeVector{_px, _py, _pz};}
+  inline double mass2() const {return _E*_E - _px*_px - _py*_py - _pz*_pz;}
+  /// Signed mass, negative for space-like momenta (as in Rivet)
+  inline double mass() const
+  {
+    const double m2 {mass2()};
+    return m2 < 0. ? -sqrt(-m2) : sqrt(m2);
+  }
+
+  inline FourMomentum& operator+=(const FourMomentum& p)
+  {
+    _E += p._E; _px += p._px; _py += p._py; _pz += p._pz;
+    return *this;
+  }
+  inline FourMomentum& operator-=(const FourMomentum& p)
+  {
+    _E -= p._E; _px -= p._px; _py -= p._py; _pz -= p._pz;
+    return *this;
+  }
+  inline FourMomentum& operator*=(const double a)
+  {
+    _E *= a; _px *= a; _py *= a; _pz *= a;
+    return *this;
+  }
+  inline FourMomentum operator-() const {return FourMomentum{-_E, -_px, -_py, -_pz};}
+
+  inline friend FourMomentum operator+(FourMomentum a, const FourMomentum& b) {return a += b;}
+  inline friend FourMomentum operator-(FourMomentum a, const FourMomentum& b) {return a -= b;}
+  inline friend FourMomentum operator*(const double a, FourMomentum p) {return p *= a;}
+  inline friend FourMomentum operator*(FourMomentum p, const double a) {return p *= a;}
+
+  inline friend std::ostream& operator<<(std::ostream& os, const FourMomentum& p)
+  {
+    os << "(" << p.E() << ", " << p.px() << ", " << p.py() << ", " << p.pz() << ")";
+    return os;
+  }
+};
+
+typedef std::vector<FourMomentum> FourMomenta;
+
+#endif
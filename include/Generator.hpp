@@ -0,0 +1,72 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "BatchShower.hpp"
+#include "Kernels.hpp"
+#include "Matrix.hpp"
+#include "QCD.hpp"
+#include "Random.hpp"
+#include "Shower.hpp"
+
+/// Flat particle record written into caller-provided buffers
+struct OutParticle
+{
+  int flavour;
+  int colour[2];
+  double p[4]; /// E, px, py, pz
+};
+
+struct GeneratorSettings
+{
+  double ecms, t0;
+  long unsigned int seed;
+  size_t asOrder;
+  double mz, asMZ, mb, mc;
+  /// events per BatchShower batch, 0 for the single-event Shower
+  size_t batch;
+  /// first emission from the Sudakov table, for Shower and BatchShower,
+  /// optionally kept on disk
+  bool sudakov;
+  std::string sudakovFile;
+  GeneratorSettings()
+  : ecms{91.2}, t0{1.}, seed{123456}, asOrder{1},
+    mz{91.1876}, asMZ{0.118}, mb{4.75}, mc{1.3}, batch{0},
+    sudakov{false}, sudakovFile{}
+  {}
+};
+
+/// e+e- -> q qbar matrix element followed by the parton shower,
+/// usable without Rivet/HepMC.
+class Generator
+{
+private:
+  AlphaS _alphaS;
+  Random _ran;
+  myMatrix _me;
+  Shower _shower;
+  BatchShower _batchShower;
+  size_t _batch;
+  long int _nEvents;
+public:
+  Generator(const GeneratorSettings& settings = GeneratorSettings{});
+  ~Generator() {}
+  Generator(const Generator&) = delete;
+  Generator& operator=(const Generator&) = delete;
+
+  /// Generate one showered event
+  EventInfo Next();
+  /// Generate one event into out[0..capacity). The two incoming leptons
+  /// come first. Returns the number of particles in the event; when it
+  /// exceeds capacity only the first capacity particles are written.
+  size_t Next(OutParticle* out, const size_t capacity, double* weight = nullptr);
+  /// Replace evts by n new events, showered in one batch if the
+  /// settings ask for BatchShower, one at a time otherwise
+  void Next(std::vector<EventInfo>& evts, const size_t n);
+  inline long int GetEvents() const {return _nEvents;}
+};
+
+#endif
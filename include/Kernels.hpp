@@ -1,6 +1,8 @@
 #ifndef KERNELS_HPP
 #define KERNELS_HPP
 
+#include <cmath>
+#include <ostream>
 #include <vector>
 
 #include "QCD.hpp"
@@ -28,7 +30,7 @@ public:
 
 inline Kernels::~Kernels() {}
 
-class Pqq : public Kernels
+class Pqq final : public Kernels
 {
 public:
   Pqq(const int& fl, Random *random) : Kernels({fl, fl, 21}, random) {}
@@ -54,7 +56,7 @@ public:
   }
 };
 
-class Pgg : public Kernels
+class Pgg final : public Kernels
 {
 public:
   Pgg(Random *random) : Kernels({21,21,21}, random) {}
@@ -80,7 +82,7 @@ public:
   }
 };
 
-class Pgq : public Kernels
+class Pgq final : public Kernels
 {
 public:
   Pgq(const int& fl, Random *random) : Kernels({21,fl,-fl}, random) {}
@@ -2,14 +2,14 @@
 #define MATRIX_HPP
 
 #include <cmath>
+#include <ostream>
 #include <random>
+#include <vector>
 
 #include "Particle.hpp"
 #include "QCD.hpp"
 #include "Random.hpp"
 
-#include "Rivet/Rivet.hh"
-
 struct EWParameters
 {
   double mz2, gz2, alpha0, sin2tw, qe, ae;
@@ -24,6 +24,10 @@ struct EventInfo {
   long int EvtNumber;
   double dxs, lome;
   std::vector<Particle> Particles;
+  /// shower starting scale, mass squared of the incoming leptons
+  inline double GetQ2() const {
+    return (Particles[0].GetMomentum() + Particles[1].GetMomentum()).mass2();
+  }
   inline friend std::ostream& operator<<(std::ostream& os, EventInfo& evt){
     os << "XS       : " << evt.dxs<<"\n";
     os << "MEWeight : " << evt.lome << "\n";
@@ -0,0 +1,16 @@
+#ifndef PID_HPP
+#define PID_HPP
+
+/// PDG codes used by the shower core
+namespace PID {
+  constexpr int DQUARK   = 1;
+  constexpr int UQUARK   = 2;
+  constexpr int SQUARK   = 3;
+  constexpr int CQUARK   = 4;
+  constexpr int BQUARK   = 5;
+  constexpr int ELECTRON = 11;
+  constexpr int POSITRON = -ELECTRON;
+  constexpr int GLUON    = 21;
+}
+
+#endif
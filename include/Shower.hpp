@@ -2,9 +2,14 @@
 #define SHOWER_HPP
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "Config.hpp"
+#include "Kernels.hpp"
 #include "Particle.hpp"
+#include "QCD.hpp"
+#include "Random.hpp"
 
 struct DipoleInfo{
   typedef std::vector<Particle> Partons;
@@ -30,24 +35,112 @@ private:
   class AlphaS* _alphaS;
   std::vector<std::unique_ptr<class Kernels> > _kernels;
   DipoleInfo _dipole;
+  std::unique_ptr<class SudakovCache> _sudakov;
+  std::string _sudakovFile;
+  bool _sudakovChecked;
+
+  void MakeEmission(class EventInfo& evt, const double z, const double y, int& c);
 public:
   typedef std::pair<int,int>  Colour;
   typedef std::vector<Colour> Colours;
   typedef std::vector<Particle> Partons;
+  typedef std::vector<std::unique_ptr<class Kernels> > KernelList;
   /// pass reference to alphaS class, random class and
   /// shower stopping scale, t0
   Shower(class AlphaS* alphaS, class Random* ran,
          const double t0);
-  ~Shower() {}
+  ~Shower();
+
+  /// Sample the first emission off a Born q qbar dipole from a tabulated
+  /// Sudakov (SudakovCache) instead of the veto algorithm. If file is
+  /// given the table is read from it, and written back whenever it has
+  /// to be rebuilt because alpha_s, the cutoff or the dipole mass changed.
+  /// Only one Born dipole mass is cached: if it changes from event to
+  /// event the table (about 2.7 MB on disk) is rebuilt and rewritten
+  /// every time. Returns false, with a warning, if file could not be read.
+  bool UseSudakovCache(const std::string& file = "");
+  /// Force the alpha_s check of the Sudakov table on the next event;
+  /// cutoff and dipole mass are checked on every event anyway.
+  inline void InvalidateSudakovCache() {_sudakovChecked = false;}
+  inline bool UsesSudakovCache() const {return bool(_sudakov);}
+  /// With the Sudakov table, the first emission off a Born q qbar dipole
+  /// below tActual, otherwise nothing. tActual is lowered to the emission
+  /// scale, or to the cutoff if there is none, and c, the last colour
+  /// index used, is incremented by the emission. Used by Run and BatchShower.
+  void FirstEmission(class EventInfo& evt, double& tActual, int& c);
 
-  Rivet::FourMomenta MakeKinematics(const double& z, const double &y,
-                                    const double& phi, const Rivet::FourMomentum& pijt,
-                                    const Rivet::FourMomentum& pkt) const;
+  /// Compiled into the multiversioned callers, Shower::MakeEmission
+  /// and BatchShower::MakeEmissions
+  TOYSHOWER_INLINE FourMomenta MakeKinematics(const double& z, const double &y,
+                                              const double& phi,
+                                              const FourMomentum& pijt,
+                                              const FourMomentum& pkt) const
+  {
+    const FourMomentum Q {pijt + pkt};
+    /// kt in the decay frame
+    const double rkt {sqrt(Q.mass2() * y * z * (1.-z))};
+    ThreeVector vkt1 {cross(pijt.vector3(),pkt.vector3())};
+    if(vkt1.mod() < 1.e-6){
+      vkt1 = cross(pijt.vector3(),ThreeVector{1.,0.,0.});
+    }
+    FourMomentum kt1 {0.0,vkt1[0],vkt1[1],vkt1[2]};
+    kt1 *= (rkt * cos(phi) / kt1.vector3().mod());
+    /// Boost to CMS
+    ThreeVector vkt2CMS {
+      cross((Particle::Boost(Q,pijt)).vector3(), kt1.vector3())
+    };
+    vkt2CMS *= rkt * sin(phi) / vkt2CMS.mod();
+    const FourMomentum kt2 {
+      Particle::BoostBack(Q,FourMomentum{0.0,vkt2CMS[0],vkt2CMS[1],vkt2CMS[2]})
+    };
+    const FourMomentum pi {z * pijt + (1. - z) * y * pkt + kt1 + kt2};
+    const FourMomentum pj {(1. - z) * pijt + z * y * pkt - kt1 - kt2};
+    const FourMomentum pk {(1. - y) * pkt};
+    return FourMomenta{pi,pj,pk};
+  }
   Colours MakeColours(const std::vector<int>& flavs, const Colour& colij,
                       const Colour& colk);
+  /// as above, with the new colour index c supplied by the caller
+  Colours MakeColours(const std::vector<int>& flavs, const Colour& colij,
+                      const Colour& colk, const int c) const;
   void Run(class EventInfo &evt, const double t);
   void GeneratePoint(class EventInfo& evt);
   void SelectSplitSpect(class EventInfo& evt, double& t);
+
+  /// Steps of the veto algorithm, shared with BatchShower. K is Kernels,
+  /// or one of the final kernel classes to avoid the virtual calls.
+  /// zp and integrated overestimate of kern on a dipole of mass m2,
+  /// false if the dipole cannot radiate above the cutoff
+  template <class K>
+  inline bool Overestimate(const K& kern, const double m2,
+                           double& zp, double& overestimate) const
+  {
+    if(m2 < 4. * _tEnd) return false;
+    zp = 0.5 * (1. + sqrt(1. - 4.*_tEnd/m2));
+    overestimate = _alphaSMax/(2. * M_PI) * kern.Integral(1.-zp,zp);
+    return true;
+  }
+  /// trial scale below t for the inverse of an integrated overestimate
+  inline double TrialScale(const double t, const double invOverestimate) const
+  {
+    return t * pow((*_ran)(), invOverestimate);
+  }
+  /// z and y of a trial at scale t, true if it survives the veto
+  template <class K>
+  inline bool Accept(const K& kern, const double t, const double m2,
+                     const double zp, double& z, double& y) const
+  {
+    z = kern.GenerateZ(1. - zp, zp);
+    y = t/m2/z/(1.-z);
+    if(y >= 1) return false;
+    const double sf {(1. - y) * (*_alphaS)(t) * kern.Value(z,y)};
+    const double overestimate{_alphaSMax * kern.Estimate(z)};
+    return (*_ran)() < sf / overestimate;
+  }
+
+  inline const KernelList& GetKernels() const {return _kernels;}
+  inline double GetCutoff()             const {return _tEnd;}
+  inline double GetAlphaSMax()          const {return _alphaSMax;}
   static bool CheckEvent (class EventInfo &evt);
   static bool ColourConnected(const Particle& pa, const Particle& pb);
 };
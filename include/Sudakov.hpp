@@ -0,0 +1,52 @@
+#ifndef SUDAKOV_HPP
+#define SUDAKOV_HPP
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+/// Tabulated no-emission probability and z distribution of the first
+/// emission off a q qbar colour-singlet dipole of mass squared m2, for
+/// a shower cutoff t0. The exact emission density per dipole,
+///   alpha_s(t)/(2 pi) (1-y) Pqq(z,y)  in dlog(t) dz,  y < 1,
+/// is integrated on a grid in log(t) and v = log(1-z), so the first
+/// emission is sampled directly rather than with the veto algorithm.
+/// Both dipoles of the Born state are summed in the Sudakov.
+class SudakovCache
+{
+private:
+  double _t0, _m2, _ltMin, _dlt;
+  size_t _nt, _nz;
+  std::vector<double> _S;     /// Sudakov exponent from t_i up to m2/4
+  std::vector<double> _zcdf;  /// per t_i, CDF of w in [0,1] on nz points
+  std::vector<double> _tRef;  /// reference scales of the alpha_s check
+  std::vector<double> _asRef; /// alpha_s at the reference scales
+
+  void SetReferenceScales();
+  static void ZRange(const double t, const double m2, double& vmin, double& vmax);
+public:
+  /// empty cache, never valid
+  SudakovCache()
+  : _t0{0.}, _m2{0.}, _ltMin{0.}, _dlt{0.}, _nt{0}, _nz{0}
+  {}
+  SudakovCache(class AlphaS& alphaS, const double t0, const double m2,
+               const size_t nt=512, const size_t nz=256);
+  ~SudakovCache() {}
+
+  /// true if the table was built for this alpha_s, cutoff and dipole mass
+  bool Valid(class AlphaS& alphaS, const double t0, const double m2) const;
+  /// cheap part of Valid, without the alpha_s check
+  inline bool Matches(const double t0, const double m2) const
+  {
+    return _nt > 0 and std::abs(t0 - _t0) <= 1.e-12 * _t0
+      and std::abs(m2 - _m2) <= 1.e-12 * _m2;
+  }
+  /// Sample the first emission below tStart. Returns false if there
+  /// is none above the cutoff, otherwise sets t and z of the splitter.
+  bool Generate(class Random& ran, const double tStart, double& t, double& z) const;
+
+  bool Save(const std::string& file) const;
+  bool Load(const std::string& file);
+};
+
+#endif
@@ -0,0 +1,58 @@
+#!/usr/bin/env bash
+## Builds toyshower-bench in every optimisation variant and reports the
+## event throughput of each one.
+##   scripts/bench_variants.sh [events] [build-root]
+## The PGO variants are trained on the same benchmark workload: an
+## instrumented build is run once, then rebuilt in place with the profile.
+set -euo pipefail
+
+EVENTS=${1:-100000}
+ROOT=${2:-_bench}
+TRAIN_EVENTS=${TRAIN_EVENTS:-$(( EVENTS / 4 > 1000 ? EVENTS / 4 : 1000 ))}
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+JOBS=$(nproc 2>/dev/null || echo 1)
+
+declare -A VARIANTS=(
+  [baseline]=""
+  [native]="-DTOYSHOWER_MARCH=native"
+  [fmv]="-DTOYSHOWER_FMV=ON"
+  [lto]="-DTOYSHOWER_LTO=ON"
+  [pgo]="PGO"
+  [lto-pgo-native]="PGO -DTOYSHOWER_LTO=ON -DTOYSHOWER_MARCH=native"
+)
+ORDER=(baseline native fmv lto pgo lto-pgo-native)
+
+configure_and_build() {
+  local dir=$1; shift
+  cmake -S "$SRC" -B "$dir" -DCMAKE_BUILD_TYPE=Release "$@" > "$dir.log" 2>&1
+  cmake --build "$dir" --target toyshower-bench -j"$JOBS" >> "$dir.log" 2>&1
+}
+
+run_bench() {
+  "$1/src/toyshower-bench" "$2" | awk -F': ' '/Events\/s/ {print $2}'
+}
+
+mkdir -p "$ROOT"
+declare -A RESULT
+for v in "${ORDER[@]}"; do
+  dir="$ROOT/$v"
+  read -r -a flags <<< "${VARIANTS[$v]}"
+  echo ">> $v" >&2
+  if [[ ${flags[0]:-} == PGO ]]; then
+    flags=("${flags[@]:1}")
+    rm -rf "$dir/pgo-profile"
+    configure_and_build "$dir" "${flags[@]}" -DTOYSHOWER_PGO=GENERATE
+    "$dir/src/toyshower-bench" "$TRAIN_EVENTS" > /dev/null
+    configure_and_build "$dir" "${flags[@]}" -DTOYSHOWER_PGO=USE
+  else
+    configure_and_build "$dir" "${flags[@]}" -DTOYSHOWER_PGO=OFF
+  fi
+  RESULT[$v]=$(run_bench "$dir" "$EVENTS")
+done
+
+base=${RESULT[baseline]}
+printf "%-16s %14s %8s\n" "variant" "events/s" "speedup"
+for v in "${ORDER[@]}"; do
+  printf "%-16s %14.1f %8.3f\n" "$v" "${RESULT[$v]}" \
+    "$(awk -v a="${RESULT[$v]}" -v b="$base" 'BEGIN {print a/b}')"
+done
@@ -0,0 +1,188 @@
+#include "BatchShower.hpp"
+
+#include "Config.hpp"
+#include "Kernels.hpp"
+#include "Matrix.hpp"
+#include "Random.hpp"
+#include "QCD.hpp"
+
+#include <algorithm>
+
+void BatchShower::Channels::clear()
+{
+  split.clear();
+  spect.clear();
+  kern.clear();
+  m2.clear();
+  zp.clear();
+  invOverestimate.clear();
+}
+
+BatchShower::BatchShower(AlphaS* alphaS, Random* ran,
+                         const double t0, const size_t batchSize)
+: _shower{alphaS, ran, t0}, _tEnd{t0}, _ran{ran},
+  _batchSize{std::max<size_t>(batchSize, 1)}
+{
+  for(const auto& kern : _shower.GetKernels()){
+    if(kern->flavs[0] != 21)      _kernType.push_back(PQQ);
+    else if(kern->flavs[1] == 21) _kernType.push_back(PGG);
+    else                          _kernType.push_back(PGQ);
+  }
+  _evts.resize(_batchSize);
+  _tActual.resize(_batchSize);
+  _c.resize(_batchSize);
+  _channels.resize(_batchSize);
+  _active.resize(_batchSize);
+  _chan.resize(_batchSize);
+  _t.resize(_batchSize);
+  _z.resize(_batchSize);
+  _y.resize(_batchSize);
+  _accept.resize(_batchSize);
+}
+
+void BatchShower::Run(std::vector<EventInfo>& evts)
+{
+  for(size_t first{0}; first < evts.size(); first += _batchSize){
+    RunBatch(evts.data() + first, std::min(_batchSize, evts.size() - first));
+  }
+}
+
+void BatchShower::RunBatch(EventInfo* evts, const size_t n)
+{
+  size_t nactive{0};
+  for(size_t i{0}; i < n; ++i){
+    _evts[i]    = &evts[i];
+    _tActual[i] = evts[i].GetQ2();
+    _c[i]       = 1;
+    _shower.FirstEmission(evts[i], _tActual[i], _c[i]);
+    FindChannels(i);
+    if(_tActual[i] > _tEnd) _active[nactive++] = i;
+  }
+  while(nactive > 0){
+    nactive = SelectSplitSpect(nactive);
+    Veto(nactive);
+    MakeEmissions(nactive);
+  }
+}
+
+/// Radiating channels of an event, in the order Shower::SelectSplitSpect
+/// visits them so that the random numbers are drawn in the same order
+void BatchShower::FindChannels(const size_t slot)
+{
+  const Shower::KernelList& kernels {_shower.GetKernels()};
+  const Shower::Partons& partons {_evts[slot]->Particles};
+  Channels& ch {_channels[slot]};
+  ch.clear();
+  for(size_t split{2}; split < partons.size(); ++split){
+    for(size_t spect{2}; spect < partons.size(); ++spect){
+      if(spect == split) continue;
+      if(not Shower::ColourConnected(partons[split], partons[spect])) continue;
+      const double m2 {(partons[split].GetMomentum() + partons[spect].GetMomentum()).mass2()};
+      for(size_t kern{0}; kern < kernels.size(); ++kern){
+        if(kernels[kern]->flavs[0] != partons[split].GetFlavour()) continue;
+        double zp{}, overestimate{};
+        if(not _shower.Overestimate(*kernels[kern], m2, zp, overestimate)) continue;
+        ch.split.push_back(split);
+        ch.spect.push_back(spect);
+        ch.kern.push_back(kern);
+        ch.m2.push_back(m2);
+        ch.zp.push_back(zp);
+        ch.invOverestimate.push_back(1./overestimate);
+      }
+    }
+  }
+}
+
+/// Trial emission for every active event. Events whose trial scale falls
+/// below the cutoff are finished and compacted out; returns the number
+/// of events still active.
+TOYSHOWER_HOT
+size_t BatchShower::SelectSplitSpect(const size_t nactive)
+{
+  size_t n{0};
+  for(size_t k{0}; k < nactive; ++k){
+    const size_t slot {_active[k]};
+    const Channels& ch {_channels[slot]};
+    const size_t nch {ch.size()};
+    const double tStart {_tActual[slot]};
+    _tt.resize(nch);
+    for(size_t c{0}; c < nch; ++c){
+      _tt[c] = _shower.TrialScale(tStart, ch.invOverestimate[c]);
+    }
+    double t {_tEnd};
+    size_t sel{0};
+    for(size_t c{0}; c < nch; ++c){
+      if(_tt[c] > t){
+        t   = _tt[c];
+        sel = c;
+      }
+    }
+    _tActual[slot] = t;
+    if(t <= _tEnd) continue;
+    _active[n] = slot;
+    _t[n]      = t;
+    _chan[n]   = sel;
+    ++n;
+  }
+  return n;
+}
+
+/// z, y and the veto for every trial, one kernel type at a time
+TOYSHOWER_HOT
+void BatchShower::Veto(const size_t nactive)
+{
+  for(auto& trials : _byType) trials.clear();
+  for(size_t k{0}; k < nactive; ++k){
+    const Channels& ch {_channels[_active[k]]};
+    _byType[_kernType[ch.kern[_chan[k]]]].push_back(k);
+  }
+  Veto<Pqq>(_byType[PQQ]);
+  Veto<Pgg>(_byType[PGG]);
+  Veto<Pgq>(_byType[PGQ]);
+}
+
+/// GCC does not clone templates, the per-type loops are inlined into
+/// the clones of Veto(nactive) instead
+template <class K>
+TOYSHOWER_INLINE
+void BatchShower::Veto(const std::vector<size_t>& trials)
+{
+  const Shower::KernelList& kernels {_shower.GetKernels()};
+  for(const size_t k : trials){
+    const Channels& ch {_channels[_active[k]]};
+    const size_t c {_chan[k]};
+    const K& kern {static_cast<const K&>(*kernels[ch.kern[c]])};
+    _accept[k] = _shower.Accept(kern, _t[k], ch.m2[c], ch.zp[c], _z[k], _y[k]);
+  }
+}
+
+/// Kinematics and colour flow for the accepted trials
+TOYSHOWER_HOT
+void BatchShower::MakeEmissions(const size_t nactive)
+{
+  const Shower::KernelList& kernels {_shower.GetKernels()};
+  for(size_t k{0}; k < nactive; ++k){
+    if(not _accept[k]) continue;
+    const size_t slot {_active[k]};
+    const Channels& ch {_channels[slot]};
+    const size_t c {_chan[k]};
+    Shower::Partons& partons {_evts[slot]->Particles};
+    Particle& split {partons[ch.split[c]]};
+    Particle& spect {partons[ch.spect[c]]};
+    const std::vector<int>& flavs {kernels[ch.kern[c]]->flavs};
+
+    const double phi {2. * M_PI * (*_ran)()};
+    FourMomenta moms {_shower.MakeKinematics(_z[k], _y[k], phi,
+                                             split.GetMomentum(), spect.GetMomentum())};
+    _c[slot] += 1;
+    Shower::Colours cols {_shower.MakeColours(flavs, split.GetColour(),
+                                              spect.GetColour(), _c[slot])};
+    split.SetColour(cols[0]);
+    split.SetFlavour(flavs[1]);
+    split.SetMomentum(moms[0]);
+
+    spect.SetMomentum(moms[2]);
+    partons.push_back({flavs[2], moms[1], cols[1]});
+    FindChannels(slot);
+  }
+}
@@ -0,0 +1,47 @@
+#include "Generator.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Runs matrix element + shower without any analysis and reports
+/// the event throughput. Usage: toyshower-bench [events] [seed] [batch] [sudakov]
+/// With batch > 0 events are showered by BatchShower, batch at a time.
+/// With sudakov = 1 the first emission comes from the Sudakov table.
+int main(int argc, char** argv)
+{
+  const long int TotEvents {argc > 1 ? std::atol(argv[1]) : 100000};
+  GeneratorSettings settings;
+  if(argc > 2) settings.seed    = std::strtoul(argv[2], nullptr, 10);
+  if(argc > 3) settings.batch   = size_t(std::atol(argv[3]));
+  if(argc > 4) settings.sudakov = std::atoi(argv[4]) != 0;
+  Generator gen{settings};
+
+  /// single events go through the caller-buffer API
+  std::vector<OutParticle> buffer(256);
+  std::vector<EventInfo> evts;
+  size_t nPartons{0};
+  const auto start {std::chrono::steady_clock::now()};
+  if(settings.batch == 0){
+    for (long int i{0}; i < TotEvents; ++i){
+      nPartons += gen.Next(buffer.data(), buffer.size()) - 2;
+    }
+  } else {
+    for (long int i{0}; i < TotEvents; i += settings.batch){
+      gen.Next(evts, std::min<long int>(settings.batch, TotEvents - i));
+      for(const auto& evt : evts) nPartons += evt.Particles.size() - 2;
+    }
+  }
+  const std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - start};
+
+  std::cout << "Mode      : "
+            << (settings.batch == 0 ? "single" : "batch " + std::to_string(settings.batch))
+            << (settings.sudakov ? ", Sudakov first emission" : "") << "\n"
+            << "Events    : " << TotEvents << "\n"
+            << "<partons> : " << double(nPartons) / TotEvents << "\n"
+            << "Time [s]  : " << elapsed.count() << "\n"
+            << "Events/s  : " << TotEvents / elapsed.count() << std::endl;
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include "Generator.hpp"
+
+Generator::Generator(const GeneratorSettings& settings)
+: _alphaS{settings.asOrder, settings.mz, settings.asMZ, settings.mb, settings.mc},
+  _ran{settings.seed}, _me{settings.ecms, &_ran},
+  _shower{&_alphaS, &_ran, settings.t0},
+  _batchShower{&_alphaS, &_ran, settings.t0, settings.batch},
+  _batch{settings.batch}, _nEvents{0}
+{
+  if(settings.sudakov){
+    _shower.UseSudakovCache(settings.sudakovFile);
+    _batchShower.UseSudakovCache(settings.sudakovFile);
+  }
+}
+
+EventInfo Generator::Next()
+{
+  EventInfo evt{_me.GeneratePoint()};
+  _shower.Run(evt, evt.GetQ2());
+  evt.EvtNumber = _nEvents++;
+  return evt;
+}
+
+size_t Generator::Next(OutParticle* out, const size_t capacity, double* weight)
+{
+  const EventInfo evt{Next()};
+  if(weight) *weight = evt.dxs;
+  const size_t n {evt.Particles.size()};
+  for(size_t i{0}; i < n and i < capacity; ++i){
+    const Particle& p {evt.Particles[i]};
+    const FourMomentum mom {p.GetMomentum()};
+    out[i].flavour   = p.GetFlavour();
+    out[i].colour[0] = p.GetColour().first;
+    out[i].colour[1] = p.GetColour().second;
+    out[i].p[0] = mom.E();
+    out[i].p[1] = mom.px();
+    out[i].p[2] = mom.py();
+    out[i].p[3] = mom.pz();
+  }
+  return n;
+}
+
+void Generator::Next(std::vector<EventInfo>& evts, const size_t n)
+{
+  evts.clear();
+  if(_batch == 0){
+    for(size_t i{0}; i < n; ++i) evts.push_back(Next());
+    return;
+  }
+  for(size_t i{0}; i < n; ++i){
+    evts.push_back(_me.GeneratePoint());
+    evts.back().EvtNumber = _nEvents++;
+  }
+  _batchShower.Run(evts);
+}
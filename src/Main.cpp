@@ -56,8 +56,7 @@ int main()
 
   for (size_t i{0}; i < TotEvents; ++i){
     EventInfo evt{me.GeneratePoint()};
-    const double t {(evt.Particles[0].GetMomentum() + evt.Particles[1].GetMomentum()).mass2()};
-    shower.Run(evt, t);
+    shower.Run(evt, evt.GetQ2());
     evt.EvtNumber = i;
     HepMC::GenEvent hepevt;
     ToHepMCEvent(evt,hepevt);
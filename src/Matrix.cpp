@@ -1,5 +1,7 @@
 #include "Matrix.hpp"
 
+#include "PID.hpp"
+
 myMatrix::myMatrix(const double& ecms, Random* random)
 : _ecms{ecms}, _ewparams{}, ran{random}
 {}
@@ -9,8 +11,8 @@ double myMatrix::ME2(const int& flav, const double& s, const double& t) const
   const double ve {_ewparams.ae - 2. * _ewparams.qe * _ewparams.sin2tw};
   double qf{}, af{};
   const bool IsUpQuark {
-    (abs(flav) == Rivet::PID::UQUARK) or
-    (abs(flav) == Rivet::PID::CQUARK)
+    (abs(flav) == PID::UQUARK) or
+    (abs(flav) == PID::CQUARK)
   };
   if (IsUpQuark) {
     qf = 2./3.;
@@ -44,19 +46,19 @@ EventInfo myMatrix::GeneratePoint()
   const double st  {sqrt(1. - ct * ct)};
   const double phi {2.* M_PI * (*ran)()};
 
-  const Rivet::FourMomentum pa{_ecms/2.,0.,0.,_ecms/2.};
-  const Rivet::FourMomentum pb{_ecms/2.,0.,0.,-_ecms/2.};
-  const Rivet::FourMomentum p1{_ecms/2.,
-                               _ecms/2. * st * cos(phi),
-                               _ecms/2. * st * sin(phi),
-                               _ecms/2. * ct};
-  const Rivet::FourMomentum p2{_ecms/2.,
-                               -_ecms/2. * st * cos(phi),
-                               -_ecms/2. * st * sin(phi),
-                               -_ecms/2. * ct};
+  const FourMomentum pa{_ecms/2.,0.,0.,_ecms/2.};
+  const FourMomentum pb{_ecms/2.,0.,0.,-_ecms/2.};
+  const FourMomentum p1{_ecms/2.,
+                        _ecms/2. * st * cos(phi),
+                        _ecms/2. * st * sin(phi),
+                        _ecms/2. * ct};
+  const FourMomentum p2{_ecms/2.,
+                        -_ecms/2. * st * cos(phi),
+                        -_ecms/2. * st * sin(phi),
+                        -_ecms/2. * ct};
 
-  evtinfo.Particles.push_back({Rivet::PID::POSITRON, -pa});
-  evtinfo.Particles.push_back({Rivet::PID::ELECTRON, -pb});
+  evtinfo.Particles.push_back({PID::POSITRON, -pa});
+  evtinfo.Particles.push_back({PID::ELECTRON, -pb});
   const int fl {ran->randint()};
   evtinfo.Particles.push_back({fl, p1 ,std::make_pair<int,int>(1,0)});
   evtinfo.Particles.push_back({ -fl, p2,std::make_pair<int,int>(0,1)});
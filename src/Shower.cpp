@@ -1,15 +1,19 @@
 #include "Shower.hpp"
 
+#include "Config.hpp"
 #include "Kernels.hpp"
 #include "Matrix.hpp"
 #include "Random.hpp"
 #include "QCD.hpp"
+#include "Sudakov.hpp"
 
 #include <iomanip>
+#include <iostream>
 
 Shower::Shower(AlphaS* alphaS, Random* ran,
                const double t0)
-: _c{0}, _alphaS{alphaS}, _ran{ran}, _tEnd{t0}, _tActual{-1.0}
+: _c{0}, _alphaS{alphaS}, _ran{ran}, _tEnd{t0}, _tActual{-1.0},
+  _sudakovChecked{false}
 {
    _alphaSMax = (*_alphaS)(_tEnd);
   /// load Pqq (q -> q g) in kernels
@@ -25,51 +29,18 @@ Shower::Shower(AlphaS* alphaS, Random* ran,
   _kernels.shrink_to_fit();
 }
 
-Rivet::FourMomenta Shower::MakeKinematics(const double& z, const double &y,
-                                          const double& phi, const Rivet::FourMomentum& pijt,
-                                          const Rivet::FourMomentum& pkt) const
+Shower::~Shower() {}
+
+bool Shower::UseSudakovCache(const std::string& file)
 {
-  //std::cout.precision(16);
-  Rivet::FourMomentum Q {pijt + pkt};
-  //std::cout << "Q : " << Q << std::endl;
-  /// kt in the decay frame
-  const double rkt {sqrt(Q.mass2() * y * z * (1.-z))};
-  //std::cout << "rkt : " << rkt << std::endl;
-  Rivet::ThreeVector vkt1 {Rivet::cross(pijt.vector3(),pkt.vector3())};
-  //std::cout << " vkt1 : " << vkt1 << std::endl;
-  if(vkt1.mod() < 1.e-6){
-    vkt1 = Rivet::cross(pijt.vector3(),{1.,0.,0.});
-  }
-  //std::cout << " vkt1 : " << vkt1 << " , " << cos(phi) << " , "<< vkt1.mod() << std::endl;
-  Rivet::FourMomentum kt1 {0.0,vkt1[0],vkt1[1],vkt1[2]};
-  kt1 *= (rkt * cos(phi) / kt1.vector3().mod());
-  //std::cout << "kt1 : " << kt1 << std::endl;
-  /// Boost to CMS
-
-  //std::cout << "boosted pijt : " <<  Particle::Boost(Q,pijt)<< std::endl;
-
-  Rivet::ThreeVector vkt2CMS {
-    Rivet::cross((Particle::Boost(Q,pijt)).vector3(), kt1.vector3())
-  };
-  vkt2CMS *= rkt * sin(phi) / vkt2CMS.mod();
-  //std::cout << "kt2CMS : " << vkt2CMS << std::endl;
-  Rivet::FourMomentum kt2 {
-    Particle::BoostBack(Q,Rivet::FourMomentum{0.0,vkt2CMS[0],vkt2CMS[1],vkt2CMS[2]})
-  };
-  //std::cout << "kt2 : " << kt2 << std::endl;
-  Rivet::FourMomentum pi {
-    z * pijt + (1. - z) * y * pkt + kt1 + kt2
-  };
-  //std::cout << "pi : " << pi << std::endl;
-  Rivet::FourMomentum pj {
-    (1. - z) * pijt + z * y * pkt - kt1 - kt2
-  };
-  //std::cout << "pj : " << pj << std::endl;
-  Rivet::FourMomentum pk {
-    (1. - y) * pkt
-  };
-  //std::cout << "pk : " << pk << std::endl;
-  return Rivet::FourMomenta{pi,pj,pk};
+  _sudakov.reset(new SudakovCache{});
+  _sudakovFile = file;
+  _sudakovChecked = false;
+  if(_sudakovFile.empty()) return true;
+  if(_sudakov->Load(_sudakovFile)) return true;
+  std::cerr << "Shower: no usable Sudakov table in " << _sudakovFile
+            << ", building it on the first event" << std::endl;
+  return false;
 }
 
 Shower::Colours Shower::MakeColours(const std::vector<int>& flavs,
@@ -77,22 +48,30 @@ Shower::Colours Shower::MakeColours(const std::vector<int>& flavs,
                                     const Colour& colk)
 {
   _c += 1;
+  return MakeColours(flavs, colij, colk, _c);
+}
+
+Shower::Colours Shower::MakeColours(const std::vector<int>& flavs,
+                                    const Colour& colij,
+                                    const Colour& colk,
+                                    const int c) const
+{
   /// splitter is quark
   if(flavs[0]!=21){
     if(flavs[0] > 0){
-      return {{_c,0},{colij.first, _c}};
+      return {{c,0},{colij.first, c}};
     } else{
-      return {{0,_c},{_c,colij.second}};
+      return {{0,c},{c,colij.second}};
     }
   } else{ /// splitter is gluon
     if(flavs[1] == 21){
       if(colij.first == colk.second){
         if(colij.second == colk.first and (*_ran)() > 0.5){
-          return {{colij.first, _c},{_c, colij.second}};
+          return {{colij.first, c},{c, colij.second}};
         }
-        return {{_c, colij.second},{colij.first, _c}};
+        return {{c, colij.second},{colij.first, c}};
       } else{
-        return {{colij.first, _c},{_c, colij.second}};
+        return {{colij.first, c},{c, colij.second}};
       }
     } else {
       if(flavs[1] > 0 ){
@@ -108,11 +87,13 @@ void Shower::Run(class EventInfo &evt, const double t)
 {
   _c = 1;
   _tActual = t;
+  FirstEmission(evt, _tActual, _c);
   while( _tActual > _tEnd){
     GeneratePoint(evt);
   }
 }
 
+TOYSHOWER_HOT
 void Shower::GeneratePoint(EventInfo& evt)
 {
   while (_tActual > _tEnd)
@@ -122,38 +103,9 @@ void Shower::GeneratePoint(EventInfo& evt)
     SelectSplitSpect(evt,t);
     _tActual = t;
     if(t > _tEnd){
-      double z {_dipole.selected->get()->GenerateZ(
-        1. - _dipole.zp, _dipole.zp)};
-      double y {t/_dipole.m2/z/(1.-z)};
-      if(y >= 1) continue;
-      const double sf {(1. - y) * (*_alphaS)(t) * _dipole.selected->get()->Value(z,y)};
-      const double overestimate{_alphaSMax * _dipole.selected->get()->Estimate(z)};
-      if ((*_ran)() < sf / overestimate){
-        const double phi {2. * M_PI * (*_ran)()};
-        Rivet::FourMomenta moms = MakeKinematics(z,y,phi,_dipole.split->GetMomentum(),
-                                                 _dipole.spect->GetMomentum());
-        Colours cols {MakeColours(_dipole.selected->get()->flavs,
-                                  _dipole.split->GetColour(),_dipole.spect->GetColour())};
-        // std::cout << "\nSplitting at t : " << _tActual << "\n"
-        //           << _dipole.split->GetFlavour() << " -> "
-        //           << _dipole.selected->get()->flavs[1]
-        //           << " " << _dipole.selected->get()->flavs[2] << "\n"
-        //           << _dipole.split->GetMomentum() << " -> "
-        //           << moms[0]
-        //           << " " << moms[1] << "\n"
-        //           << _dipole.split->GetColour() << " -> "
-        //           << cols[0]
-        //           << " " << cols[1] << "\n";
-
-        _dipole.split->SetColour(cols[0]);
-        _dipole.split->SetFlavour(_dipole.selected->get()->flavs[1]);
-        _dipole.split->SetMomentum(moms[0]);
-
-        _dipole.spect->SetMomentum(moms[2]);
-        evt.Particles.push_back({
-          _dipole.selected->get()->flavs[2], moms[1], cols[1]
-        });
-
+      double z{}, y{};
+      if (Accept(*_dipole.selected->get(), t, _dipole.m2, _dipole.zp, z, y)){
+        MakeEmission(evt, z, y, _c);
         return;
       }
     }
@@ -161,6 +113,79 @@ void Shower::GeneratePoint(EventInfo& evt)
   return;
 }
 
+/// Apply the splitting selected in _dipole with variables z, y
+TOYSHOWER_HOT
+void Shower::MakeEmission(EventInfo& evt, const double z, const double y, int& c)
+{
+  const double phi {2. * M_PI * (*_ran)()};
+  FourMomenta moms = MakeKinematics(z,y,phi,_dipole.split->GetMomentum(),
+                                    _dipole.spect->GetMomentum());
+  c += 1;
+  Colours cols {MakeColours(_dipole.selected->get()->flavs,
+                            _dipole.split->GetColour(),_dipole.spect->GetColour(), c)};
+  // std::cout << "\nSplitting at t : " << _tActual << "\n"
+  //           << _dipole.split->GetFlavour() << " -> "
+  //           << _dipole.selected->get()->flavs[1]
+  //           << " " << _dipole.selected->get()->flavs[2] << "\n"
+  //           << _dipole.split->GetMomentum() << " -> "
+  //           << moms[0]
+  //           << " " << moms[1] << "\n"
+  //           << _dipole.split->GetColour() << " -> "
+  //           << cols[0]
+  //           << " " << cols[1] << "\n";
+
+  _dipole.split->SetColour(cols[0]);
+  _dipole.split->SetFlavour(_dipole.selected->get()->flavs[1]);
+  _dipole.split->SetMomentum(moms[0]);
+
+  _dipole.spect->SetMomentum(moms[2]);
+  evt.Particles.push_back({
+    _dipole.selected->get()->flavs[2], moms[1], cols[1]
+  });
+}
+
+/// First emission off a Born q qbar dipole from the Sudakov table,
+/// the evolution then continues from its scale with the veto algorithm
+void Shower::FirstEmission(EventInfo& evt, double& tActual, int& c)
+{
+  if(not _sudakov or evt.Particles.size() != 4) return;
+  Partons::iterator q {evt.Particles.begin() + 2}, qbar {evt.Particles.begin() + 3};
+  if(q->GetFlavour() == 21 or qbar->GetFlavour() == 21) return;
+  if(not ColourConnected(*q, *qbar)) return;
+  const double m2 {(q->GetMomentum() + qbar->GetMomentum()).mass2()};
+  /// alpha_s has no setters, so its check is only repeated when the
+  /// table is installed, explicitly invalidated or the dipole changes
+  if(not _sudakovChecked or not _sudakov->Matches(_tEnd, m2)){
+    if(not _sudakov->Valid(*_alphaS, _tEnd, m2)){
+      _sudakov.reset(new SudakovCache{*_alphaS, _tEnd, m2});
+      if(not _sudakovFile.empty() and not _sudakov->Save(_sudakovFile)){
+        std::cerr << "Shower: cannot write Sudakov table to "
+                  << _sudakovFile << std::endl;
+      }
+    }
+    _sudakovChecked = true;
+  }
+  double t{}, z{};
+  if(not _sudakov->Generate(*_ran, tActual, t, z)){
+    tActual = _tEnd;
+    return;
+  }
+  tActual = t;
+  if((*_ran)() < 0.5) std::swap(q, qbar);
+  for(auto kern{_kernels.begin()}; kern!=_kernels.end(); ++kern){
+    if(kern->get()->flavs[0] != q->GetFlavour() or
+       kern->get()->flavs[1] != q->GetFlavour()) continue;
+    /// MakeEmission only reads the partons and the kernel of _dipole,
+    /// the veto overestimate plays no role in this emission
+    _dipole.split    = q;
+    _dipole.spect    = qbar;
+    _dipole.selected = kern;
+    MakeEmission(evt, z, t/m2/z/(1.-z), c);
+    return;
+  }
+}
+
+TOYSHOWER_HOT
 void Shower::SelectSplitSpect(EventInfo& evt, double& t)
 {
   for(Partons::iterator split{evt.Particles.begin()+2};
@@ -172,10 +197,9 @@ void Shower::SelectSplitSpect(EventInfo& evt, double& t)
       for(auto kern{_kernels.begin()}; kern!=_kernels.end(); ++kern){
         if(kern->get()->flavs[0] != split->GetFlavour()) continue;
         double m2 {(split->GetMomentum() + spect->GetMomentum()).mass2()};
-        if(m2 < 4. * _tEnd) continue;
-        double zp {0.5 * (1. + sqrt(1. - 4.*_tEnd/m2))};
-        double overestimate {_alphaSMax/(2. * M_PI) * kern->get()->Integral(1.-zp,zp)};
-        double tt {_tActual * pow((*_ran)(), 1./overestimate)};
+        double zp{}, overestimate{};
+        if(not Overestimate(*kern->get(), m2, zp, overestimate)) continue;
+        double tt {TrialScale(_tActual, 1./overestimate)};
         if(tt > t){
           t = tt;
           _dipole.m2       = m2;
@@ -191,7 +215,7 @@ void Shower::SelectSplitSpect(EventInfo& evt, double& t)
 
 bool Shower::CheckEvent(EventInfo &evt)
 {
-  Rivet::FourMomentum TotMom {0.,0.,0.,0.};
+  FourMomentum TotMom {0.,0.,0.,0.};
   Colour ColSum {0,0};
   for(const auto& p : evt.Particles){
     TotMom += p.GetMomentum();
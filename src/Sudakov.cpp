@@ -0,0 +1,158 @@
+#include "Sudakov.hpp"
+
+#include "Kernels.hpp"
+#include "QCD.hpp"
+#include "Random.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+SudakovCache::SudakovCache(AlphaS& alphaS, const double t0, const double m2,
+                           const size_t nt, const size_t nz)
+: _t0{t0}, _m2{m2}, _ltMin{log(t0)}, _dlt{0.},
+  _nt{std::max<size_t>(nt, 2)}, _nz{std::max<size_t>(nz, 2)}
+{
+  SetReferenceScales();
+  for(const double t : _tRef){
+    _asRef.push_back(alphaS(t));
+  }
+  _S.assign(_nt, 0.);
+  _zcdf.assign(_nt * _nz, 0.);
+  /// no phase space above the cutoff, never emit
+  if(4. * _t0 >= _m2) return;
+
+  _dlt = (log(_m2/4.) - _ltMin)/(_nt - 1);
+  const Pqq kernel{1, nullptr};
+  std::vector<double> F(_nt, 0.);
+  for(size_t i{0}; i < _nt; ++i){
+    const double t {exp(_ltMin + i * _dlt)};
+    const double as {alphaS(t)/(2. * M_PI)};
+    double vmin{}, vmax{};
+    ZRange(t, _m2, vmin, vmax);
+    const double dv {(vmax - vmin)/(_nz - 1)};
+    double* cdf {&_zcdf[i * _nz]};
+    double gprev{0.};
+    for(size_t j{0}; j < _nz; ++j){
+      const double z {1. - exp(vmin + j * dv)};
+      const double y {t/_m2/z/(1.-z)};
+      /// dz = (1-z) dv
+      const double g {y < 1. ? as * (1. - y) * kernel.Value(z,y) * (1. - z) : 0.};
+      cdf[j] = (j == 0) ? 0. : cdf[j-1] + 0.5 * (g + gprev) * dv;
+      gprev = g;
+    }
+    /// two dipoles, q with qbar as spectator and vice versa
+    F[i] = 2. * cdf[_nz-1];
+    for(size_t j{0}; j < _nz; ++j){
+      cdf[j] = (F[i] > 0.) ? cdf[j] * 2. / F[i] : double(j)/(_nz - 1);
+    }
+  }
+  for(size_t i{_nt - 1}; i-- > 0;){
+    _S[i] = _S[i+1] + 0.5 * (F[i] + F[i+1]) * _dlt;
+  }
+}
+
+void SudakovCache::SetReferenceScales()
+{
+  _tRef.clear();
+  for(size_t k{0}; k < 8; ++k){
+    _tRef.push_back(_t0 * pow(_m2/_t0, k/7.));
+  }
+}
+
+/// Range of v = log(1-z) with y < 1, i.e. z(1-z) > t/m2
+void SudakovCache::ZRange(const double t, const double m2,
+                          double& vmin, double& vmax)
+{
+  const double s {sqrt(std::max(0., 1. - 4.*t/m2))};
+  vmin = log(2.*t/m2/(1. + s));
+  vmax = log(0.5 * (1. + s));
+}
+
+bool SudakovCache::Valid(AlphaS& alphaS, const double t0, const double m2) const
+{
+  if(not Matches(t0, m2)) return false;
+  if(_tRef.size() != _asRef.size()) return false;
+  for(size_t k{0}; k < _tRef.size(); ++k){
+    if(std::abs(alphaS(_tRef[k]) - _asRef[k]) > 1.e-12 * _asRef[k]) return false;
+  }
+  return true;
+}
+
+bool SudakovCache::Generate(Random& ran, const double tStart, double& t, double& z) const
+{
+  if(_dlt == 0.) return false;
+  /// Sudakov exponent at the starting scale
+  const double x {(log(tStart) - _ltMin)/_dlt};
+  double Sstart {0.};
+  if(x <= 0.){
+    Sstart = _S[0];
+  } else if(x < _nt - 1){
+    const size_t i {size_t(x)};
+    Sstart = _S[i] + (x - i) * (_S[i+1] - _S[i]);
+  }
+  const double target {Sstart - log(ran())};
+  if(target >= _S[0]) return false;
+
+  /// S is decreasing, find S[lo] >= target > S[lo+1]
+  size_t lo{0}, hi{_nt - 1};
+  while(hi - lo > 1){
+    const size_t mid {(lo + hi)/2};
+    if(_S[mid] >= target) lo = mid;
+    else hi = mid;
+  }
+  const double frac {(_S[lo] - target)/(_S[lo] - _S[lo+1])};
+  t = exp(_ltMin + (lo + frac) * _dlt);
+
+  /// z from the neighbouring rows, mixed linearly in log(t)
+  const size_t row {ran() < frac ? lo + 1 : lo};
+  const double* cdf {&_zcdf[row * _nz]};
+  const double r {ran()};
+  size_t j {size_t(std::upper_bound(cdf, cdf + _nz, r) - cdf)};
+  j = std::min(std::max<size_t>(j, 1), _nz - 1) - 1;
+  const double width {cdf[j+1] - cdf[j]};
+  const double w {(j + (width > 0. ? (r - cdf[j])/width : 0.))/(_nz - 1)};
+  double vmin{}, vmax{};
+  ZRange(t, _m2, vmin, vmax);
+  z = 1. - exp(vmin + w * (vmax - vmin));
+  return true;
+}
+
+bool SudakovCache::Save(const std::string& file) const
+{
+  std::ofstream out{file};
+  if(not out) return false;
+  out << std::setprecision(17);
+  out << "ToyShower-SudakovCache 1\n"
+      << _t0 << " " << _m2 << " " << _nt << " " << _nz << " " << _asRef.size() << "\n";
+  for(const double v : _asRef) out << v << "\n";
+  for(const double v : _S)     out << v << "\n";
+  for(const double v : _zcdf)  out << v << "\n";
+  return bool(out);
+}
+
+bool SudakovCache::Load(const std::string& file)
+{
+  std::ifstream in{file};
+  std::string tag;
+  int version{0};
+  if(not (in >> tag >> version) or tag != "ToyShower-SudakovCache" or version != 1)
+    return false;
+  SudakovCache cache;
+  size_t nref{0};
+  if(not (in >> cache._t0 >> cache._m2 >> cache._nt >> cache._nz >> nref)) return false;
+  if(cache._nt < 2 or cache._nz < 2 or cache._t0 <= 0.) return false;
+  cache._asRef.resize(nref);
+  cache._S.resize(cache._nt);
+  cache._zcdf.resize(cache._nt * cache._nz);
+  for(auto& v : cache._asRef) in >> v;
+  for(auto& v : cache._S)     in >> v;
+  for(auto& v : cache._zcdf)  in >> v;
+  if(not in) return false;
+  cache._ltMin = log(cache._t0);
+  cache.SetReferenceScales();
+  if(4. * cache._t0 < cache._m2)
+    cache._dlt = (log(cache._m2/4.) - cache._ltMin)/(cache._nt - 1);
+  *this = cache;
+  return true;
+}
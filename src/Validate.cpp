@@ -0,0 +1,412 @@
+#include "Generator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Physics regression for the evolution modes.
+/// Every mode showers a fixed-seed sample, every event is checked for
+/// momentum and colour conservation, and the multiplicity, Durham y23,
+/// y34 and thrust distributions are compared with the single-event
+/// Shower. Modes marked exact must reproduce the reference event by
+/// event; the others are compared with chi2 and Kolmogorov-Smirnov tests.
+/// All modes, the reference included, are also compared with a frozen
+/// baseline file written by the original Shower: exactly (histograms and
+/// a checksum of the binned event record) when the events and seed are
+/// those of the baseline and the mode is exact, with chi2 otherwise, so
+/// that a change of Shower, the kernels, alpha_s or the matrix element
+/// is caught even though it moves every mode together.
+/// The Generator caller-buffer API is checked against its EventInfo output.
+/// Usage: toyshower-validate [events] [seed] [baseline] [write]
+/// With write the reference mode is run and written to the baseline file.
+/// The exit code is non-zero if any mode fails.
+
+namespace {
+
+  struct Mode
+  {
+    std::string name;
+    size_t batch; /// 0 : single-event Shower
+    bool exact;   /// same random sequence as the reference
+    bool sudakov; /// first emission from the Sudakov table
+  };
+
+  struct Sample
+  {
+    std::vector<double> mult, y23, y34, tau;
+    long int failed {0};
+    double seconds {0.};
+  };
+
+  struct Observable
+  {
+    std::string name;
+    std::vector<double> Sample::* values;
+    double lo, hi;
+    size_t nbins;
+  };
+
+  /// Frozen reference output, see ReadBaseline
+  struct Baseline
+  {
+    long int events {0};
+    long unsigned int seed {0};
+    std::uint64_t checksum {0};
+    std::vector<std::vector<double> > hists;
+  };
+
+  constexpr double CHI2_PMIN {1.e-3};
+  /// KS critical value for alpha = 1e-3
+  constexpr double KS_CALPHA {1.949};
+
+  /// Durham y_{23} and y_{34} of the final-state partons, E-scheme
+  void DurhamY(const Shower::Partons& partons, double& y23, double& y34)
+  {
+    std::vector<FourMomentum> jets;
+    double evis{0.};
+    for(auto p{partons.begin() + 2}; p != partons.end(); ++p){
+      jets.push_back(p->GetMomentum());
+      evis += p->GetMomentum().E();
+    }
+    const double Q2 {evis * evis};
+    y23 = y34 = 0.;
+    while(jets.size() > 2){
+      double ymin {1.e99};
+      size_t imin{0}, jmin{1};
+      for(size_t i{0}; i < jets.size(); ++i){
+        for(size_t j{i + 1}; j < jets.size(); ++j){
+          const ThreeVector pi {jets[i].vector3()}, pj {jets[j].vector3()};
+          const double cth {(pi[0]*pj[0] + pi[1]*pj[1] + pi[2]*pj[2])/pi.mod()/pj.mod()};
+          const double emin {std::min(jets[i].E(), jets[j].E())};
+          const double y {2. * emin * emin * (1. - cth) / Q2};
+          if(y < ymin){
+            ymin = y;
+            imin = i;
+            jmin = j;
+          }
+        }
+      }
+      if(jets.size() == 3) y23 = ymin;
+      if(jets.size() == 4) y34 = ymin;
+      jets[imin] += jets[jmin];
+      jets.erase(jets.begin() + jmin);
+    }
+  }
+
+  /// Thrust, T = max over signs of |sum_k e_k p_k| / sum_k |p_k|, the
+  /// candidate sign patterns being the planes spanned by two momenta.
+  double Thrust(const Shower::Partons& partons)
+  {
+    std::vector<ThreeVector> p;
+    double sum{0.};
+    for(auto it{partons.begin() + 2}; it != partons.end(); ++it){
+      p.push_back(it->GetMomentum().vector3());
+      sum += p.back().mod();
+    }
+    double tmax{0.};
+    for(size_t i{0}; i < p.size(); ++i){
+      for(size_t j{i + 1}; j < p.size(); ++j){
+        const ThreeVector n {cross(p[i], p[j])};
+        ThreeVector base{};
+        for(size_t k{0}; k < p.size(); ++k){
+          if(k == i or k == j) continue;
+          const double sgn {p[k][0]*n[0] + p[k][1]*n[1] + p[k][2]*n[2] > 0. ? 1. : -1.};
+          for(size_t c{0}; c < 3; ++c) base[c] += sgn * p[k][c];
+        }
+        for(const double si : {1., -1.}){
+          for(const double sj : {1., -1.}){
+            const ThreeVector t {base[0] + si * p[i][0] + sj * p[j][0],
+                                 base[1] + si * p[i][1] + sj * p[j][1],
+                                 base[2] + si * p[i][2] + sj * p[j][2]};
+            tmax = std::max(tmax, t.mod());
+          }
+        }
+      }
+    }
+    return tmax / sum;
+  }
+
+  void Fill(Sample& sample, EventInfo& evt)
+  {
+    if(not Shower::CheckEvent(evt)) sample.failed += 1;
+    double y23{}, y34{};
+    DurhamY(evt.Particles, y23, y34);
+    sample.mult.push_back(evt.Particles.size() - 2);
+    sample.y23.push_back(log10(std::max(y23, 1.e-10)));
+    sample.y34.push_back(log10(std::max(y34, 1.e-10)));
+    sample.tau.push_back(1. - Thrust(evt.Particles));
+  }
+
+  Sample RunMode(const Mode& mode, const long int nevents,
+                 const long unsigned int seed)
+  {
+    GeneratorSettings settings;
+    settings.seed    = seed;
+    settings.batch   = mode.batch;
+    settings.sudakov = mode.sudakov;
+    Generator gen{settings};
+
+    Sample sample;
+    std::vector<EventInfo> evts;
+    double seconds{0.};
+    const long int chunk {std::max<long int>(mode.batch, 1)};
+    for(long int i{0}; i < nevents; i += chunk){
+      const auto start {std::chrono::steady_clock::now()};
+      gen.Next(evts, std::min(chunk, nevents - i));
+      const std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - start};
+      seconds += elapsed.count();
+      for(auto& evt : evts) Fill(sample, evt);
+    }
+    sample.seconds = seconds;
+    return sample;
+  }
+
+  size_t Bin(const double v, const Observable& obs)
+  {
+    const long int bin {long(std::floor((v - obs.lo) / (obs.hi - obs.lo) * obs.nbins))};
+    return std::min<long int>(std::max<long int>(bin, 0), obs.nbins - 1);
+  }
+
+  std::vector<double> Histogram(const std::vector<double>& values, const Observable& obs)
+  {
+    std::vector<double> h(obs.nbins, 0.);
+    for(const double v : values) h[Bin(v, obs)] += 1.;
+    return h;
+  }
+
+  /// FNV-1a over the bin of every observable, event by event. Bins rather
+  /// than the values, so that the last bits of libm do not matter.
+  std::uint64_t Checksum(const Sample& sample, const std::vector<Observable>& observables)
+  {
+    std::uint64_t h {14695981039346656037ull};
+    for(size_t i{0}; i < sample.mult.size(); ++i){
+      for(const auto& obs : observables){
+        h ^= Bin((sample.*obs.values)[i], obs);
+        h *= 1099511628211ull;
+      }
+    }
+    return h;
+  }
+
+  /// ToyShower-ValidateBaseline 1
+  /// events seed checksum
+  /// one line per observable: name nbins lo hi counts...
+  bool WriteBaseline(const std::string& file, const Sample& sample,
+                     const std::vector<Observable>& observables,
+                     const long int nevents, const long unsigned int seed)
+  {
+    std::ofstream out{file};
+    if(not out) return false;
+    out << std::setprecision(17);
+    out << "ToyShower-ValidateBaseline 1\n"
+        << nevents << " " << seed << " " << Checksum(sample, observables) << "\n";
+    for(const auto& obs : observables){
+      out << obs.name << " " << obs.nbins << " " << obs.lo << " " << obs.hi;
+      for(const double n : Histogram(sample.*obs.values, obs)) out << " " << n;
+      out << "\n";
+    }
+    return bool(out);
+  }
+
+  /// false if the file cannot be read or was written with other observables
+  bool ReadBaseline(const std::string& file, const std::vector<Observable>& observables,
+                    Baseline& baseline)
+  {
+    std::ifstream in{file};
+    std::string tag;
+    int version{0};
+    if(not (in >> tag >> version) or tag != "ToyShower-ValidateBaseline" or version != 1)
+      return false;
+    if(not (in >> baseline.events >> baseline.seed >> baseline.checksum)) return false;
+    baseline.hists.clear();
+    for(const auto& obs : observables){
+      std::string name;
+      size_t nbins{0};
+      double lo{}, hi{};
+      if(not (in >> name >> nbins >> lo >> hi)) return false;
+      if(name != obs.name or nbins != obs.nbins or lo != obs.lo or hi != obs.hi) return false;
+      std::vector<double> h(nbins);
+      for(auto& n : h) in >> n;
+      baseline.hists.push_back(h);
+    }
+    return bool(in);
+  }
+
+  /// Next(OutParticle*, ...) must write the same event as Next(), truncated
+  /// to the buffer capacity, and return the full particle count
+  bool CheckBufferAPI(const long unsigned int seed)
+  {
+    GeneratorSettings settings;
+    settings.seed = seed;
+    Generator ref{settings}, gen{settings};
+    for(const size_t capacity : {size_t(64), size_t(3)}){
+      const EventInfo evt {ref.Next()};
+      std::vector<OutParticle> buffer(capacity + 1);
+      buffer[capacity].flavour = 0;
+      double weight{0.};
+      const size_t n {gen.Next(buffer.data(), capacity, &weight)};
+      if(n != evt.Particles.size() or weight != evt.dxs) return false;
+      if(buffer[capacity].flavour != 0) return false;
+      for(size_t i{0}; i < n and i < capacity; ++i){
+        const Particle& p {evt.Particles[i]};
+        const OutParticle& o {buffer[i]};
+        if(o.flavour != p.GetFlavour() or o.colour[0] != p.GetColour().first or
+           o.colour[1] != p.GetColour().second or o.p[0] != p.GetMomentum().E() or
+           o.p[1] != p.GetMomentum().px() or o.p[2] != p.GetMomentum().py() or
+           o.p[3] != p.GetMomentum().pz()) return false;
+      }
+    }
+    return true;
+  }
+
+  /// Two-sample chi2 p-value (Wilson-Hilferty approximation)
+  double Chi2PValue(const std::vector<double>& a, const std::vector<double>& b)
+  {
+    double na{0.}, nb{0.};
+    for(size_t i{0}; i < a.size(); ++i){
+      na += a[i];
+      nb += b[i];
+    }
+    double chi2{0.};
+    long int ndf{-1};
+    for(size_t i{0}; i < a.size(); ++i){
+      if(a[i] + b[i] == 0.) continue;
+      const double d {sqrt(nb/na) * a[i] - sqrt(na/nb) * b[i]};
+      chi2 += d * d / (a[i] + b[i]);
+      ndf += 1;
+    }
+    if(ndf < 1) return 1.;
+    const double k {double(ndf)};
+    const double z {(pow(chi2/k, 1./3.) - (1. - 2./(9.*k))) / sqrt(2./(9.*k))};
+    return 0.5 * erfc(z / sqrt(2.));
+  }
+
+  /// Two-sample Kolmogorov-Smirnov distance
+  double KSDistance(std::vector<double> a, std::vector<double> b)
+  {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    size_t i{0}, j{0};
+    double d{0.};
+    while(i < a.size() and j < b.size()){
+      const double x {std::min(a[i], b[j])};
+      while(i < a.size() and a[i] == x) ++i;
+      while(j < b.size() and b[j] == x) ++j;
+      d = std::max(d, std::abs(double(i)/a.size() - double(j)/b.size()));
+    }
+    return d;
+  }
+
+  /// Mode against the live reference Shower: event by event if exact,
+  /// chi2 and KS otherwise
+  bool CompareWithReference(const Mode& mode, const Sample& ref, const Sample& sample,
+                            const std::vector<Observable>& observables)
+  {
+    bool pass {true};
+    for(const auto& obs : observables){
+      const std::vector<double>& a {ref.*obs.values};
+      const std::vector<double>& b {sample.*obs.values};
+      if(mode.exact){
+        const bool same {a == b};
+        pass = pass and same;
+        std::cout << "  " << std::setw(14) << obs.name << " : "
+                  << (same ? "identical" : "DIFFERENT") << "\n";
+        continue;
+      }
+      const double p {Chi2PValue(Histogram(a, obs), Histogram(b, obs))};
+      const double d {KSDistance(a, b)};
+      const double dcrit {KS_CALPHA * sqrt(double(a.size() + b.size()) / a.size() / b.size())};
+      const bool good {p > CHI2_PMIN and d < dcrit};
+      pass = pass and good;
+      std::cout << "  " << std::setw(14) << obs.name << " : chi2 p = " << p
+                << ", KS D = " << d << " (< " << dcrit << ") "
+                << (good ? "ok" : "FAIL") << "\n";
+    }
+    return pass;
+  }
+
+}
+
+int main(int argc, char** argv)
+{
+  const long int nevents {argc > 1 ? std::atol(argv[1]) : 20000};
+  const long unsigned int seed {argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 123456};
+  const std::string baselineFile {argc > 3 ? argv[3] : ""};
+  const bool write {argc > 4 and std::string{argv[4]} == "write"};
+
+  const std::vector<Mode> modes {
+    {"reference", 0, true, false},
+    {"batch-1", 1, true, false},
+    {"batch-64", 64, false, false},
+    {"batch-1024", 1024, false, false},
+    {"sudakov", 0, false, true},
+    {"batch-64-sudakov", 64, false, true},
+  };
+  const std::vector<Observable> observables {
+    {"multiplicity", &Sample::mult, -0.5, 40.5, 41},
+    {"log10(y23)", &Sample::y23, -6., 0., 30},
+    {"log10(y34)", &Sample::y34, -6., 0., 30},
+    {"1-T", &Sample::tau, 0., 0.4, 40},
+  };
+
+  if(write){
+    const Sample sample {RunMode(modes[0], nevents, seed)};
+    if(sample.failed != 0 or not WriteBaseline(baselineFile, sample, observables, nevents, seed)){
+      std::cerr << "cannot write the baseline to " << baselineFile << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+  Baseline baseline;
+  if(not baselineFile.empty() and not ReadBaseline(baselineFile, observables, baseline)){
+    std::cerr << "cannot read the baseline " << baselineFile
+              << ", or it was written with other observables" << std::endl;
+    return 1;
+  }
+
+  bool ok {CheckBufferAPI(seed)};
+  std::cout << "=== Generator buffer API : " << (ok ? "PASS" : "FAIL") << "\n";
+  Sample ref;
+  std::cout << std::setprecision(4);
+  for(size_t m{0}; m < modes.size(); ++m){
+    const Mode& mode {modes[m]};
+    const long unsigned int modeSeed {mode.exact ? seed : seed + m};
+    const Sample sample {RunMode(mode, nevents, modeSeed)};
+    if(m == 0) ref = sample;
+    bool pass {sample.failed == 0};
+
+    std::cout << "=== " << mode.name << " : " << nevents / sample.seconds
+              << " events/s, speedup " << ref.seconds / sample.seconds
+              << ", " << sample.failed << " events violate conservation\n";
+    if(not baseline.hists.empty() and mode.exact and
+       nevents == baseline.events and modeSeed == baseline.seed){
+      bool same {Checksum(sample, observables) == baseline.checksum};
+      for(size_t o{0}; o < observables.size(); ++o){
+        const Observable& obs {observables[o]};
+        same = same and Histogram(sample.*obs.values, obs) == baseline.hists[o];
+      }
+      pass = pass and same;
+      std::cout << "  " << std::setw(14) << "baseline" << " : "
+                << (same ? "identical" : "DIFFERENT") << "\n";
+    } else if(not baseline.hists.empty()){
+      for(size_t o{0}; o < observables.size(); ++o){
+        const Observable& obs {observables[o]};
+        const double p {Chi2PValue(baseline.hists[o], Histogram(sample.*obs.values, obs))};
+        const bool good {p > CHI2_PMIN};
+        pass = pass and good;
+        std::cout << "  " << std::setw(14) << obs.name << " : baseline chi2 p = " << p
+                  << " " << (good ? "ok" : "FAIL") << "\n";
+      }
+    }
+    if(m > 0) pass = CompareWithReference(mode, ref, sample, observables) and pass;
+    std::cout << "  " << (pass ? "PASS" : "FAIL") << std::endl;
+    ok = ok and pass;
+  }
+  return ok ? 0 : 1;
+}